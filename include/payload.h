@@ -1,3 +1,6 @@
+#pragma once
+
+#include <stddef.h>
 #include <stdint.h>
 
 /**
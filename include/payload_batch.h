@@ -0,0 +1,223 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "payload.h"
+
+class PayloadBatchPool;
+
+/**
+ * @brief Used to pass a batch of payloads together with their device ids and receive timestamps between stages.
+ *
+ * The frames, device ids and timestamps are stored in separate contiguous columns borrowed from a PayloadBatchPool.
+ * A batch can only be moved, which only transfers the column pointers, and returns its storage to the pool once destroyed.
+ */
+class PayloadBatch {
+
+public:
+  PayloadBatch();
+  PayloadBatch(const PayloadBatch&) = delete;
+  PayloadBatch(PayloadBatch&& other) noexcept;
+  ~PayloadBatch();
+  PayloadBatch& operator=(const PayloadBatch&) = delete;
+  PayloadBatch& operator=(PayloadBatch&& rhs) noexcept;
+
+  /**
+   * @brief Used to check whether the batch holds storage from a pool.
+   *
+   * @return true Used to denote that the batch can hold payloads.
+   * @return false Used to denote that the batch is empty, moved from, released or the pool was exhausted.
+   */
+  bool IsValid() const;
+
+  /**
+   * @brief Used to append a payload with its device id and receive timestamp to the batch. The batch must not be full.
+   *
+   * @param frame Used to denote the payload to append.
+   * @param deviceId Used to denote the id of the device that sent the payload.
+   * @param timestamp Used to denote the time at which the payload was received.
+   */
+  void StrictPushBack(const Payload& frame, const uint32_t deviceId, const uint64_t timestamp);
+
+  /**
+   * @brief Used to get the payload at the given index of the batch.
+   *
+   * @param index Used to denote the position in the batch. Valid range: [0 to size - 1].
+   * @return Payload& Used to denote the payload stored in the batch.
+   */
+  Payload& StrictGetFrame(const size_t index);
+
+  /**
+   * @brief Used to get the payload at the given index of the batch.
+   *
+   * @param index Used to denote the position in the batch. Valid range: [0 to size - 1].
+   * @return const Payload& Used to denote the payload stored in the batch.
+   */
+  const Payload& StrictGetFrame(const size_t index) const;
+
+  /**
+   * @brief Used to get the device id at the given index of the batch.
+   *
+   * @param index Used to denote the position in the batch. Valid range: [0 to size - 1].
+   * @return uint32_t Used to denote the id of the device that sent the payload.
+   */
+  uint32_t StrictGetDeviceId(const size_t index) const;
+
+  /**
+   * @brief Used to get the receive timestamp at the given index of the batch.
+   *
+   * @param index Used to denote the position in the batch. Valid range: [0 to size - 1].
+   * @return uint64_t Used to denote the time at which the payload was received.
+   */
+  uint64_t StrictGetTimestamp(const size_t index) const;
+
+  /**
+   * @brief Used to get the pointer to the contiguous payload column of the batch.
+   *
+   * @return Payload* Used to denote the first payload of the batch.
+   */
+  Payload* GetFrames();
+
+  /**
+   * @brief Used to get the pointer to the contiguous payload column of the batch.
+   *
+   * @return const Payload* Used to denote the first payload of the batch.
+   */
+  const Payload* GetFrames() const;
+
+  /**
+   * @brief Used to get the pointer to the contiguous device id column of the batch.
+   *
+   * @return uint32_t* Used to denote the first device id of the batch.
+   */
+  uint32_t* GetDeviceIds();
+
+  /**
+   * @brief Used to get the pointer to the contiguous device id column of the batch.
+   *
+   * @return const uint32_t* Used to denote the first device id of the batch.
+   */
+  const uint32_t* GetDeviceIds() const;
+
+  /**
+   * @brief Used to get the pointer to the contiguous timestamp column of the batch.
+   *
+   * @return uint64_t* Used to denote the first receive timestamp of the batch.
+   */
+  uint64_t* GetTimestamps();
+
+  /**
+   * @brief Used to get the pointer to the contiguous timestamp column of the batch.
+   *
+   * @return const uint64_t* Used to denote the first receive timestamp of the batch.
+   */
+  const uint64_t* GetTimestamps() const;
+
+  /**
+   * @brief Used to get the amount of payloads in the batch.
+   *
+   * @return size_t Used to denote the amount of payloads in the batch.
+   */
+  size_t GetSize() const;
+
+  /**
+   * @brief Used to get the maximum amount of payloads the batch can hold.
+   *
+   * @return size_t Used to denote the maximum amount of payloads in the batch.
+   */
+  size_t GetCapacity() const;
+
+  /**
+   * @brief Used to empty the batch so it can be refilled without giving its storage back to the pool.
+   *
+   */
+  void Clear();
+
+  /**
+   * @brief Used to give the storage of the batch back to its pool before the batch is destroyed.
+   *
+   */
+  void Release();
+
+private:
+  friend class PayloadBatchPool;
+
+  PayloadBatch(PayloadBatchPool* const pool, const size_t slot, Payload* const frames, uint32_t* const deviceIds, uint64_t* const timestamps, const size_t capacity);
+
+  PayloadBatchPool* mPool;
+  size_t mSlot;
+  Payload* mFrames;
+  uint32_t* mDeviceIds;
+  uint64_t* mTimestamps;
+  size_t mSize;
+  size_t mCapacity;
+};
+
+/**
+ * @brief Used to preallocate the storage of a fixed amount of PayloadBatch objects and recycle it between batches.
+ *
+ * All storage is allocated once on construction, every column is aligned to a cache line.
+ * Acquiring and releasing batches never touches the heap. The pool is not thread-safe and must outlive its batches.
+ * Throws std::length_error on construction when the total size of all batches does not fit in a size_t.
+ */
+class PayloadBatchPool {
+
+public:
+  PayloadBatchPool(const size_t batchCount, const size_t batchCapacity);
+  PayloadBatchPool(const PayloadBatchPool&) = delete;
+  PayloadBatchPool(PayloadBatchPool&&) = delete;
+  ~PayloadBatchPool();
+  PayloadBatchPool& operator=(const PayloadBatchPool&) = delete;
+  PayloadBatchPool& operator=(PayloadBatchPool&&) = delete;
+
+  /**
+   * @brief Used to take an empty batch from the pool.
+   *
+   * @return PayloadBatch Used to denote the acquired batch, which is not valid when the pool is exhausted.
+   */
+  PayloadBatch Acquire();
+
+  /**
+   * @brief Used to get the amount of batches that can still be acquired from the pool.
+   *
+   * @return size_t Used to denote the amount of available batches.
+   */
+  size_t GetAvailableCount() const;
+
+  /**
+   * @brief Used to get the total amount of batches of the pool.
+   *
+   * @return size_t Used to denote the amount of batches the pool was constructed with.
+   */
+  size_t GetBatchCount() const;
+
+  /**
+   * @brief Used to get the capacity of every batch of the pool.
+   *
+   * @return size_t Used to denote the maximum amount of payloads in one batch.
+   */
+  size_t GetBatchCapacity() const;
+
+private:
+  friend class PayloadBatch;
+
+  void Release(const size_t slot);
+
+  /*[Slot Start, repeated mBatchCount times, every column aligned to 64 bytes]
+    [Frames, mBatchCapacity * 10 bytes]
+    [Device ids, mBatchCapacity * 4 bytes]
+    [Timestamps, mBatchCapacity * 8 bytes]
+  [Slot End] */
+  size_t mBatchCount;
+  size_t mBatchCapacity;
+  size_t mDeviceIdsOffset;
+  size_t mTimestampsOffset;
+  size_t mSlotSize;
+  std::unique_ptr<uint8_t[]> mStorage;
+  uint8_t* mArena;
+  std::vector<size_t> mFreeSlots;
+};
@@ -0,0 +1,275 @@
+#include "payload_batch.h"
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Keeps the frames column packed, with every Payload directly after the previous one.
+static_assert(sizeof(Payload) == 10, "Payload must not contain padding");
+
+namespace
+{
+  const size_t kColumnAlignment = 64;
+
+  size_t AlignUp(const size_t size)
+  {
+    return ((size + kColumnAlignment - 1) & ~(kColumnAlignment - 1));
+  }
+}
+
+PayloadBatch::PayloadBatch()
+  : mPool{ nullptr }
+  , mSlot{ 0 }
+  , mFrames{ nullptr }
+  , mDeviceIds{ nullptr }
+  , mTimestamps{ nullptr }
+  , mSize{ 0 }
+  , mCapacity{ 0 }
+{
+}
+
+PayloadBatch::PayloadBatch(PayloadBatchPool* const pool, const size_t slot, Payload* const frames, uint32_t* const deviceIds, uint64_t* const timestamps, const size_t capacity)
+  : mPool{ pool }
+  , mSlot{ slot }
+  , mFrames{ frames }
+  , mDeviceIds{ deviceIds }
+  , mTimestamps{ timestamps }
+  , mSize{ 0 }
+  , mCapacity{ capacity }
+{
+}
+
+PayloadBatch::PayloadBatch(PayloadBatch&& other) noexcept
+  : PayloadBatch()
+{
+  *this = std::move(other);
+}
+
+PayloadBatch::~PayloadBatch()
+{
+  Release();
+}
+
+PayloadBatch& PayloadBatch::operator=(PayloadBatch&& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    Release();
+
+    mPool = rhs.mPool;
+    mSlot = rhs.mSlot;
+    mFrames = rhs.mFrames;
+    mDeviceIds = rhs.mDeviceIds;
+    mTimestamps = rhs.mTimestamps;
+    mSize = rhs.mSize;
+    mCapacity = rhs.mCapacity;
+
+    rhs.mPool = nullptr;
+    rhs.mFrames = nullptr;
+    rhs.mDeviceIds = nullptr;
+    rhs.mTimestamps = nullptr;
+    rhs.mSize = 0;
+    rhs.mCapacity = 0;
+  }
+
+  return *this;
+}
+
+bool PayloadBatch::IsValid() const
+{
+  return (mPool != nullptr);
+}
+
+void PayloadBatch::StrictPushBack(const Payload& frame, const uint32_t deviceId, const uint64_t timestamp)
+{
+  assert(mSize < mCapacity);
+
+  mFrames[mSize] = frame;
+  mDeviceIds[mSize] = deviceId;
+  mTimestamps[mSize] = timestamp;
+  ++mSize;
+}
+
+Payload& PayloadBatch::StrictGetFrame(const size_t index)
+{
+  assert(index < mSize);
+  return mFrames[index];
+}
+
+const Payload& PayloadBatch::StrictGetFrame(const size_t index) const
+{
+  assert(index < mSize);
+  return mFrames[index];
+}
+
+uint32_t PayloadBatch::StrictGetDeviceId(const size_t index) const
+{
+  assert(index < mSize);
+  return mDeviceIds[index];
+}
+
+uint64_t PayloadBatch::StrictGetTimestamp(const size_t index) const
+{
+  assert(index < mSize);
+  return mTimestamps[index];
+}
+
+Payload* PayloadBatch::GetFrames()
+{
+  return mFrames;
+}
+
+const Payload* PayloadBatch::GetFrames() const
+{
+  return mFrames;
+}
+
+uint32_t* PayloadBatch::GetDeviceIds()
+{
+  return mDeviceIds;
+}
+
+const uint32_t* PayloadBatch::GetDeviceIds() const
+{
+  return mDeviceIds;
+}
+
+uint64_t* PayloadBatch::GetTimestamps()
+{
+  return mTimestamps;
+}
+
+const uint64_t* PayloadBatch::GetTimestamps() const
+{
+  return mTimestamps;
+}
+
+size_t PayloadBatch::GetSize() const
+{
+  return mSize;
+}
+
+size_t PayloadBatch::GetCapacity() const
+{
+  return mCapacity;
+}
+
+void PayloadBatch::Clear()
+{
+  mSize = 0;
+}
+
+void PayloadBatch::Release()
+{
+  if (mPool == nullptr)
+  {
+    return;
+  }
+
+  mPool->Release(mSlot);
+
+  mPool = nullptr;
+  mFrames = nullptr;
+  mDeviceIds = nullptr;
+  mTimestamps = nullptr;
+  mSize = 0;
+  mCapacity = 0;
+}
+
+PayloadBatchPool::PayloadBatchPool(const size_t batchCount, const size_t batchCapacity)
+  : mBatchCount{ batchCount }
+  , mBatchCapacity{ batchCapacity }
+  , mDeviceIdsOffset{ 0 }
+  , mTimestampsOffset{ 0 }
+  , mSlotSize{ 0 }
+  , mArena{ nullptr }
+{
+  assert(batchCount > 0);
+  assert(batchCapacity > 0);
+
+  // Every column is padded by less than kColumnAlignment, so this keeps the slot size from overflowing.
+  if (batchCapacity > (SIZE_MAX - 3 * kColumnAlignment) / (sizeof(Payload) + sizeof(uint32_t) + sizeof(uint64_t)))
+  {
+    throw std::length_error("PayloadBatchPool batch capacity is too large");
+  }
+
+  mDeviceIdsOffset = AlignUp(batchCapacity * sizeof(Payload));
+  mTimestampsOffset = mDeviceIdsOffset + AlignUp(batchCapacity * sizeof(uint32_t));
+  mSlotSize = mTimestampsOffset + AlignUp(batchCapacity * sizeof(uint64_t));
+
+  if (batchCount > (SIZE_MAX - kColumnAlignment) / mSlotSize)
+  {
+    throw std::length_error("PayloadBatchPool batch count is too large");
+  }
+
+  mStorage.reset(new uint8_t[batchCount * mSlotSize + kColumnAlignment]);
+
+  const uintptr_t storageAddress = reinterpret_cast<uintptr_t>(mStorage.get());
+  mArena = mStorage.get() + (AlignUp(storageAddress) - storageAddress);
+
+  mFreeSlots.reserve(batchCount);
+  for (size_t slot = batchCount; slot > 0; --slot)
+  {
+    uint8_t* const slotBase = mArena + (slot - 1) * mSlotSize;
+    for (size_t i = 0; i < batchCapacity; ++i)
+    {
+      new (slotBase + i * sizeof(Payload)) Payload();
+      new (slotBase + mDeviceIdsOffset + i * sizeof(uint32_t)) uint32_t();
+      new (slotBase + mTimestampsOffset + i * sizeof(uint64_t)) uint64_t();
+    }
+
+    mFreeSlots.push_back(slot - 1);
+  }
+}
+
+PayloadBatchPool::~PayloadBatchPool()
+{
+  // Batches point into the arena, so all of them must have been returned by now.
+  assert(mFreeSlots.size() == mBatchCount);
+}
+
+PayloadBatch PayloadBatchPool::Acquire()
+{
+  if (mFreeSlots.empty())
+  {
+    return PayloadBatch();
+  }
+
+  const size_t slot = mFreeSlots.back();
+  mFreeSlots.pop_back();
+
+  uint8_t* const slotBase = mArena + slot * mSlotSize;
+  return PayloadBatch(this,
+                      slot,
+                      reinterpret_cast<Payload*>(slotBase),
+                      reinterpret_cast<uint32_t*>(slotBase + mDeviceIdsOffset),
+                      reinterpret_cast<uint64_t*>(slotBase + mTimestampsOffset),
+                      mBatchCapacity);
+}
+
+size_t PayloadBatchPool::GetAvailableCount() const
+{
+  return mFreeSlots.size();
+}
+
+size_t PayloadBatchPool::GetBatchCount() const
+{
+  return mBatchCount;
+}
+
+size_t PayloadBatchPool::GetBatchCapacity() const
+{
+  return mBatchCapacity;
+}
+
+void PayloadBatchPool::Release(const size_t slot)
+{
+  assert(slot < mBatchCount);
+  assert(mFreeSlots.size() < mBatchCount);
+
+  // Capacity was reserved up front, so this never reallocates.
+  mFreeSlots.push_back(slot);
+}
@@ -0,0 +1,246 @@
+#include <stdint.h>
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+#include <payload_batch.h>
+
+// PayloadBatchPool tests
+TEST(PayloadBatchPoolTest, ConstructorGivesCorrectCounts) {
+  const PayloadBatchPool pool { 4, 32 };
+
+  EXPECT_EQ(pool.GetBatchCount(), 4);
+  EXPECT_EQ(pool.GetBatchCapacity(), 32);
+  EXPECT_EQ(pool.GetAvailableCount(), 4);
+}
+
+TEST(PayloadBatchPoolTest, ConstructorKillsOnZeroInput) {
+  EXPECT_DEATH(PayloadBatchPool(0, 16), ".*");
+  EXPECT_DEATH(PayloadBatchPool(4, 0), ".*");
+}
+
+TEST(PayloadBatchPoolTest, ConstructorThrowsOnOverflowingSize) {
+  EXPECT_THROW(PayloadBatchPool(1, SIZE_MAX), std::length_error);
+  EXPECT_THROW(PayloadBatchPool(1, (SIZE_MAX >> 1) + 1), std::length_error);
+  EXPECT_THROW(PayloadBatchPool(1, SIZE_MAX / sizeof(uint64_t)), std::length_error);
+  EXPECT_THROW(PayloadBatchPool(SIZE_MAX, 1), std::length_error);
+  EXPECT_THROW(PayloadBatchPool(SIZE_MAX / 64, 16), std::length_error);
+}
+
+TEST(PayloadBatchPoolTest, AcquireGivesEmptyValidBatch) {
+  PayloadBatchPool pool { 2, 16 };
+
+  const PayloadBatch batch = pool.Acquire();
+
+  EXPECT_EQ(batch.IsValid(), true);
+  EXPECT_EQ(batch.GetSize(), 0);
+  EXPECT_EQ(batch.GetCapacity(), 16);
+  EXPECT_EQ(pool.GetAvailableCount(), 1);
+}
+
+TEST(PayloadBatchPoolTest, AcquireOnExhaustedPoolGivesInvalidBatch) {
+  PayloadBatchPool pool { 1, 16 };
+  const PayloadBatch firstBatch = pool.Acquire();
+
+  const PayloadBatch secondBatch = pool.Acquire();
+
+  EXPECT_EQ(firstBatch.IsValid(), true);
+  EXPECT_EQ(secondBatch.IsValid(), false);
+  EXPECT_EQ(secondBatch.GetCapacity(), 0);
+}
+
+TEST(PayloadBatchPoolTest, DestroyedBatchGivesStorageBackToPool) {
+  PayloadBatchPool pool { 1, 16 };
+  const Payload* firstFrames = nullptr;
+  {
+    const PayloadBatch batch = pool.Acquire();
+    firstFrames = batch.GetFrames();
+    EXPECT_EQ(pool.GetAvailableCount(), 0);
+  }
+  EXPECT_EQ(pool.GetAvailableCount(), 1);
+
+  const PayloadBatch recycledBatch = pool.Acquire();
+
+  EXPECT_EQ(recycledBatch.GetFrames(), firstFrames);
+}
+
+TEST(PayloadBatchPoolTest, ColumnsAreCacheLineAligned) {
+  PayloadBatchPool pool { 3, 7 };
+
+  const PayloadBatch batches[3] = { pool.Acquire(), pool.Acquire(), pool.Acquire() };
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(batches[i].IsValid(), true);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(batches[i].GetFrames()) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(batches[i].GetDeviceIds()) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(batches[i].GetTimestamps()) % 64, 0);
+  }
+  EXPECT_NE(batches[0].GetFrames(), batches[1].GetFrames());
+  EXPECT_NE(batches[0].GetFrames(), batches[2].GetFrames());
+  EXPECT_NE(batches[1].GetFrames(), batches[2].GetFrames());
+}
+
+// PayloadBatch constructor and operator tests
+TEST(PayloadBatchConstructorTest, EmptyConstructorGivesInvalidBatch) {
+  const PayloadBatch batch {};
+
+  EXPECT_EQ(batch.IsValid(), false);
+  EXPECT_EQ(batch.GetSize(), 0);
+  EXPECT_EQ(batch.GetCapacity(), 0);
+}
+
+TEST(PayloadBatchConstructorTest, RvalueConstructorMovesStorage) {
+  PayloadBatchPool pool { 1, 16 };
+  PayloadBatch moveableBatch = pool.Acquire();
+  moveableBatch.StrictPushBack(Payload {}, 7, 1000);
+  const Payload* const frames = moveableBatch.GetFrames();
+
+  const PayloadBatch movedBatch { std::move(moveableBatch) };
+
+  EXPECT_EQ(movedBatch.GetFrames(), frames);
+  EXPECT_EQ(movedBatch.GetSize(), 1);
+  EXPECT_EQ(moveableBatch.IsValid(), false);
+  EXPECT_EQ(pool.GetAvailableCount(), 0);
+}
+
+TEST(PayloadBatchOperatorTest, RvalueAssignmentReleasesPreviousStorage) {
+  PayloadBatchPool pool { 2, 16 };
+  PayloadBatch firstBatch = pool.Acquire();
+  PayloadBatch secondBatch = pool.Acquire();
+  const Payload* const secondFrames = secondBatch.GetFrames();
+
+  firstBatch = std::move(secondBatch);
+
+  EXPECT_EQ(firstBatch.GetFrames(), secondFrames);
+  EXPECT_EQ(secondBatch.IsValid(), false);
+  EXPECT_EQ(pool.GetAvailableCount(), 1);
+}
+
+// PayloadBatch general tests
+class PayloadBatchGeneralTest : public ::testing::Test {
+ protected:
+  void SetUp() override { batch = pool.Acquire(); }
+  void TearDown() override { batch.Release(); }
+
+  PayloadBatchPool pool { 1, 4 };
+  PayloadBatch batch;
+};
+
+TEST_F(PayloadBatchGeneralTest, StrictPushBackGivesCorrectColumns)
+{
+  const uint8_t testArray[10] = {255, 127, 63, 31, 16, 8, 4, 2};
+  const Payload firstPayload { testArray };
+  Payload secondPayload {};
+  secondPayload.StrictSetVersionControl(3);
+
+  batch.StrictPushBack(firstPayload, 11, 100);
+  batch.StrictPushBack(secondPayload, 22, 200);
+
+  EXPECT_EQ(batch.GetSize(), 2);
+  EXPECT_EQ(batch.StrictGetFrame(0), firstPayload);
+  EXPECT_EQ(batch.StrictGetFrame(1), secondPayload);
+  EXPECT_EQ(batch.GetDeviceIds()[0], 11);
+  EXPECT_EQ(batch.GetDeviceIds()[1], 22);
+  EXPECT_EQ(batch.GetTimestamps()[0], 100);
+  EXPECT_EQ(batch.GetTimestamps()[1], 200);
+}
+
+TEST_F(PayloadBatchGeneralTest, StrictPushBackKillsOnFullBatch)
+{
+  for (size_t i = 0; i < batch.GetCapacity(); ++i)
+  {
+    batch.StrictPushBack(Payload {}, 0, 0);
+  }
+
+  EXPECT_DEATH(batch.StrictPushBack(Payload {}, 0, 0), ".*");
+}
+
+TEST_F(PayloadBatchGeneralTest, StrictGetFrameGivesElementView)
+{
+  batch.StrictPushBack(Payload {}, 5, 50);
+
+  batch.StrictGetFrame(0).StrictSetTemperature(100.0f);
+
+  EXPECT_NEAR(batch.GetFrames()[0].GetTemperature(), 100.0f, 0.2f);
+}
+
+TEST_F(PayloadBatchGeneralTest, ColumnsCanBeModifiedInPlace)
+{
+  batch.StrictPushBack(Payload {}, 1, 10);
+  batch.StrictPushBack(Payload {}, 2, 20);
+
+  Payload* const frames = batch.GetFrames();
+  uint32_t* const deviceIds = batch.GetDeviceIds();
+  uint64_t* const timestamps = batch.GetTimestamps();
+  for (size_t i = 0; i < batch.GetSize(); ++i)
+  {
+    frames[i].SetBatteryOkFlag(true);
+    deviceIds[i] += 100;
+    timestamps[i] *= 1000;
+  }
+
+  EXPECT_EQ(batch.StrictGetFrame(0).GetBatteryOkFlag(), true);
+  EXPECT_EQ(batch.StrictGetFrame(1).GetBatteryOkFlag(), true);
+  EXPECT_EQ(batch.StrictGetDeviceId(0), 101);
+  EXPECT_EQ(batch.StrictGetDeviceId(1), 102);
+  EXPECT_EQ(batch.StrictGetTimestamp(0), 10000);
+  EXPECT_EQ(batch.StrictGetTimestamp(1), 20000);
+}
+
+TEST_F(PayloadBatchGeneralTest, FramesColumnIsContiguous)
+{
+  const uint8_t firstArray[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  const uint8_t secondArray[10] = {11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+  batch.StrictPushBack(Payload { firstArray }, 0, 0);
+  batch.StrictPushBack(Payload { secondArray }, 0, 0);
+
+  const Payload* const frames = batch.GetFrames();
+  EXPECT_EQ(reinterpret_cast<const uint8_t*>(&frames[1]), reinterpret_cast<const uint8_t*>(&frames[0]) + sizeof(Payload));
+
+  const uint8_t* const firstBuffer = frames[0].GetBuffer();
+  const uint8_t* const secondBuffer = frames[1].GetBuffer();
+  for (auto i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(firstBuffer[i], firstArray[i]);
+    EXPECT_EQ(secondBuffer[i], secondArray[i]);
+  }
+}
+
+TEST_F(PayloadBatchGeneralTest, StrictGetKillsOnOutOfRangeIndex)
+{
+  batch.StrictPushBack(Payload {}, 0, 0);
+
+  EXPECT_DEATH(batch.StrictGetFrame(1), ".*");
+  EXPECT_DEATH(batch.StrictGetDeviceId(1), ".*");
+  EXPECT_DEATH(batch.StrictGetTimestamp(1), ".*");
+}
+
+TEST_F(PayloadBatchGeneralTest, StrictGetDeviceIdAndTimestampGiveCorrectValues)
+{
+  batch.StrictPushBack(Payload {}, 4000000000u, 1700000000123456ull);
+
+  EXPECT_EQ(batch.StrictGetDeviceId(0), 4000000000u);
+  EXPECT_EQ(batch.StrictGetTimestamp(0), 1700000000123456ull);
+}
+
+TEST_F(PayloadBatchGeneralTest, ClearKeepsStorage)
+{
+  const Payload* const frames = batch.GetFrames();
+  batch.StrictPushBack(Payload {}, 1, 1);
+
+  batch.Clear();
+
+  EXPECT_EQ(batch.GetSize(), 0);
+  EXPECT_EQ(batch.IsValid(), true);
+  EXPECT_EQ(batch.GetFrames(), frames);
+  EXPECT_EQ(pool.GetAvailableCount(), 0);
+}
+
+TEST_F(PayloadBatchGeneralTest, ReleaseGivesStorageBackToPool)
+{
+  batch.Release();
+
+  EXPECT_EQ(batch.IsValid(), false);
+  EXPECT_EQ(pool.GetAvailableCount(), 1);
+}